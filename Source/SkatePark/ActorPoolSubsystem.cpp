@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActorPoolSubsystem.h"
+
+#include "PoolableActor.h"
+#include "SkatePark.h"
+
+DECLARE_CYCLE_STAT(TEXT("Actor Pool Acquire"), STAT_ActorPoolAcquire, STATGROUP_SkatePark);
+DECLARE_CYCLE_STAT(TEXT("Actor Pool Release"), STAT_ActorPoolRelease, STATGROUP_SkatePark);
+
+void UActorPoolSubsystem::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (!ActorClass)
+	{
+		return;
+	}
+
+	FActorPool& Pool = Pools.FindOrAdd(ActorClass);
+	Pool.InactiveActors.Reserve(Count);
+	while (Pool.InactiveActors.Num() < Count)
+	{
+		AActor* Actor = SpawnPooledActor(ActorClass);
+		if (!Actor)
+		{
+			return;
+		}
+		SetPooledActorActive(Actor, false);
+		Pool.InactiveActors.Add(Actor);
+	}
+}
+
+AActor* UActorPoolSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActorPoolAcquire);
+
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	AActor* Actor = nullptr;
+	if (FActorPool* Pool = Pools.Find(ActorClass))
+	{
+		while (!Actor && !Pool->InactiveActors.IsEmpty())
+		{
+			// Pooled actors can still be destroyed from outside, e.g. by a level unload
+			AActor* Candidate = Pool->InactiveActors.Pop(EAllowShrinking::No);
+			if (IsValid(Candidate))
+			{
+				Actor = Candidate;
+			}
+			else
+			{
+				PruneParkedControllers();
+			}
+		}
+	}
+
+	if (!Actor)
+	{
+		Actor = SpawnPooledActor(ActorClass);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+	}
+
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetPooledActorActive(Actor, true);
+
+	if (IPoolableActor* Poolable = Cast<IPoolableActor>(Actor))
+	{
+		Poolable->OnAcquiredFromPool();
+	}
+
+	AController* Controller = nullptr;
+	if (APawn* Pawn = Cast<APawn>(Actor); Pawn && ParkedControllers.RemoveAndCopyValue(Pawn, Controller) && IsValid(Controller))
+	{
+		Controller->SetActorTickEnabled(Controller->PrimaryActorTick.bStartWithTickEnabled);
+		Controller->Possess(Pawn);
+	}
+	return Actor;
+}
+
+void UActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActorPoolRelease);
+
+	if (!IsValid(Actor))
+	{
+		PruneParkedControllers();
+		return;
+	}
+
+	if (IPoolableActor* Poolable = Cast<IPoolableActor>(Actor))
+	{
+		Poolable->OnReleasedToPool();
+	}
+
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (AController* Controller = Pawn->GetController())
+		{
+			// Player controllers are only unpossessed, restarting the player is up to the caller. AI controllers wait for the pawn to come back
+			Controller->UnPossess();
+			if (!Controller->IsPlayerController())
+			{
+				Controller->SetActorTickEnabled(false);
+				ParkedControllers.Add(Pawn, Controller);
+			}
+		}
+	}
+
+	SetPooledActorActive(Actor, false);
+	Pools.FindOrAdd(Actor->GetClass()).InactiveActors.AddUnique(Actor);
+}
+
+int32 UActorPoolSubsystem::GetInactiveCount(TSubclassOf<AActor> ActorClass) const
+{
+	const FActorPool* Pool = Pools.Find(ActorClass);
+	return Pool ? Pool->InactiveActors.Num() : 0;
+}
+
+void UActorPoolSubsystem::PruneParkedControllers()
+{
+	// A pooled pawn destroyed from outside leaves its parked controller behind, nobody else would destroy it
+	for (auto It = ParkedControllers.CreateIterator(); It; ++It)
+	{
+		if (!IsValid(It.Key()))
+		{
+			if (IsValid(It.Value()))
+			{
+				It.Value()->Destroy();
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+AActor* UActorPoolSubsystem::SpawnPooledActor(UClass* ActorClass)
+{
+	AActor* Actor = GetWorld()->SpawnActorDeferred<AActor>(ActorClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Actor)
+	{
+		UE_LOG(LogSkatePark, Warning, TEXT("Actor pool failed to spawn %s"), *GetNameSafe(ActorClass));
+		return nullptr;
+	}
+
+	if (IPoolableActor* Poolable = Cast<IPoolableActor>(Actor))
+	{
+		Poolable->PrepareForPool();
+	}
+	Actor->FinishSpawning(FTransform::Identity);
+	return Actor;
+}
+
+void UActorPoolSubsystem::SetPooledActorActive(AActor* Actor, const bool bActive)
+{
+	Actor->SetActorHiddenInGame(!bActive);
+	Actor->SetActorEnableCollision(bActive);
+	Actor->SetActorTickEnabled(bActive && Actor->PrimaryActorTick.bStartWithTickEnabled);
+	Actor->ForEachComponent(false, [bActive](UActorComponent* Component)
+	{
+		Component->SetComponentTickEnabled(bActive && Component->PrimaryComponentTick.bStartWithTickEnabled);
+	});
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorPoolSubsystem.generated.h"
+
+USTRUCT()
+struct FActorPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AActor*> InactiveActors;
+};
+
+/**
+ * Keeps released actors alive and hidden so they can be handed out again without
+ * going through actor construction and garbage collection
+ */
+UCLASS()
+class SKATEPARK_API UActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Spawns instances up front until the pool holds at least Count inactive actors of this class */
+	UFUNCTION(BlueprintCallable)
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/** Returns a pooled instance moved to Transform, spawning one if the pool is empty */
+	UFUNCTION(BlueprintCallable)
+	AActor* AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform);
+
+	template<class T>
+	T* AcquireActor(TSubclassOf<T> ActorClass, const FTransform& Transform)
+	{
+		return Cast<T>(AcquireActor(TSubclassOf<AActor>(ActorClass), Transform));
+	}
+
+	/** Hides the actor and puts it back in the pool of its class */
+	UFUNCTION(BlueprintCallable)
+	void ReleaseActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable)
+	int32 GetInactiveCount(TSubclassOf<AActor> ActorClass) const;
+
+private:
+	AActor* SpawnPooledActor(UClass* ActorClass);
+
+	static void SetPooledActorActive(AActor* Actor, bool bActive);
+
+	void PruneParkedControllers();
+
+	UPROPERTY()
+	TMap<UClass*, FActorPool> Pools;
+
+	/** AI controllers of released pawns, kept to possess the pawn again instead of spawning a new controller */
+	UPROPERTY()
+	TMap<APawn*, AController*> ParkedControllers;
+};
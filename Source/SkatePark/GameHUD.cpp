@@ -12,6 +12,7 @@ class UScoreSubsystem;
 
 void AGameHUD::InitializeHUD()
 {
+#if !UE_SERVER
 	PlayerDisplay = CreateWidget<UPlayerDisplay>(GetWorld(), PlayerDisplayClass);
 	PlayerDisplay->AddToViewport();
 
@@ -26,6 +27,7 @@ void AGameHUD::InitializeHUD()
 		GameMode->OnUpdateMatchTime.AddDynamic(this, &AGameHUD::UpdateTimer);
 		GameMode->OnMatchFinished.AddDynamic(this, &AGameHUD::OnMatchFinished);
 	}
+#endif
 }
 
 void AGameHUD::OnScored(const int32 TotalScore, const int32 NewScore, const FString& ScoreMessage)
@@ -40,8 +42,10 @@ void AGameHUD::UpdateTimer(int32 NewTime)
 
 void AGameHUD::OnMatchFinished()
 {
+#if !UE_SERVER
 	PlayerDisplay->RemoveFromParent();
 	EndGameDisplay = CreateWidget<UEndGameDisplay>(GetWorld(), EndGameDisplayClass);
 	EndGameDisplay->AddToViewport();
 	EndGameDisplay->ShowEndGame(GetGameInstance()->GetSubsystem<UScoreSubsystem>()->GetScore());
+#endif
 }
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PoolableActor.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UPoolableActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Reset hooks for actors recycled by UActorPoolSubsystem
+ */
+class SKATEPARK_API IPoolableActor
+{
+	GENERATED_BODY()
+
+public:
+	/** Called once per instance between SpawnActorDeferred and FinishSpawning, before the construction script and BeginPlay */
+	virtual void PrepareForPool() {}
+
+	/** Called every time the instance is handed out, after it has been moved to its spawn transform */
+	virtual void OnAcquiredFromPool() {}
+
+	/** Called every time the instance goes back to the pool, before it is hidden */
+	virtual void OnReleasedToPool() {}
+};
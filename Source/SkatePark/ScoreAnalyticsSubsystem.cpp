@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ScoreAnalyticsSubsystem.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	std::atomic<uint32> NextInstanceId = 1;
+
+	struct FThreadBufferSlot
+	{
+		uint32 InstanceId = 0;
+		FScoreEventBuffer* Buffer = nullptr;
+	};
+
+	/** One slot per subsystem that recorded on this thread, PIE multiplayer runs several on the game thread */
+	thread_local TArray<FThreadBufferSlot, TInlineAllocator<4>> ThreadBufferSlots;
+}
+
+UScoreAnalyticsSubsystem::UScoreAnalyticsSubsystem()
+{
+	InstanceId = NextInstanceId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void UScoreAnalyticsSubsystem::Deinitialize()
+{
+	EndMatch();
+	Super::Deinitialize();
+}
+
+void UScoreAnalyticsSubsystem::BeginMatch(const FString& MapName)
+{
+	EndMatch();
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	// Nothing drains the buffers between matches, throw away whatever came in after the last one ended
+	{
+		FScopeLock Lock(&BuffersLock);
+		TArray<FScoreEvent> StaleEvents;
+		for (const TUniquePtr<FScoreEventBuffer>& Buffer : Buffers)
+		{
+			Buffer->Drain(StaleEvents);
+			Buffer->TakeDroppedCount();
+		}
+	}
+
+	// The GUID keeps matches started in the same second, or by another process, from sharing a file
+	const FString MatchId = FString::Printf(TEXT("%s_%s_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), *MapName,
+		*FGuid::NewGuid().ToString(EGuidFormats::Base36Encoded));
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Analytics") / MatchId + TEXT(".skscore");
+	MatchStartTime = FPlatformTime::Seconds();
+	Writer = MakeUnique<FScoreAnalyticsWriter>(FilePath, MatchId, MapName, FlushIntervalSeconds, BuffersLock, Buffers);
+	bRecording.store(true, std::memory_order_release);
+}
+
+void UScoreAnalyticsSubsystem::EndMatch()
+{
+	bRecording.store(false, std::memory_order_relaxed);
+	Writer.Reset();
+}
+
+void UScoreAnalyticsSubsystem::RecordScore(const AActor* Volume, const AActor* Skater, const int32 Score)
+{
+	if (!bRecording.load(std::memory_order_acquire) || !Volume || !Skater)
+	{
+		return;
+	}
+
+	FScoreEvent Event;
+	Event.Volume = Volume->GetFName();
+	// The player id stays the same across respawns, bots get one too through their player state
+	const APawn* Pawn = Cast<APawn>(Skater);
+	const APlayerState* PlayerState = Pawn ? Pawn->GetPlayerState() : nullptr;
+	Event.SkaterId = PlayerState ? PlayerState->GetPlayerId() : INDEX_NONE;
+	Event.Time = static_cast<float>(FPlatformTime::Seconds() - MatchStartTime);
+	Event.Speed = Skater->GetVelocity().Size();
+	Event.Score = Score;
+	GetThreadBuffer().Push(Event);
+}
+
+FScoreEventBuffer& UScoreAnalyticsSubsystem::GetThreadBuffer()
+{
+	for (const FThreadBufferSlot& Slot : ThreadBufferSlots)
+	{
+		if (Slot.InstanceId == InstanceId)
+		{
+			return *Slot.Buffer;
+		}
+	}
+
+	// Only the first event this subsystem records on each thread takes the lock, a thread never gets a second buffer
+	FScopeLock Lock(&BuffersLock);
+	const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+	const TUniquePtr<FScoreEventBuffer>* ExistingBuffer = Buffers.FindByPredicate([ThreadId](const TUniquePtr<FScoreEventBuffer>& Candidate)
+	{
+		return Candidate->GetOwnerThreadId() == ThreadId;
+	});
+	FScoreEventBuffer* Buffer = ExistingBuffer ? ExistingBuffer->Get() : Buffers.Add_GetRef(MakeUnique<FScoreEventBuffer>(EventsPerThread, ThreadId)).Get();
+
+	// Slots of subsystems that are gone never match again, drop the oldest rather than growing forever
+	if (ThreadBufferSlots.Num() >= 8)
+	{
+		ThreadBufferSlots.RemoveAt(0);
+	}
+	ThreadBufferSlots.Add({ InstanceId, Buffer });
+	return *Buffer;
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ScoreAnalyticsWriter.h"
+#include "ScoreAnalyticsSubsystem.generated.h"
+
+/**
+ * Records every scoring event of a match for park layout tuning, off unless bEnabled is set, e.g. with
+ * -ini:Game:[/Script/SkatePark.ScoreAnalyticsSubsystem]:bEnabled=True
+ *
+ * Events go into a lock free buffer owned by the recording thread and a background thread drains
+ * them into Saved/Analytics/<MatchId>.skscore, read it with Tools/read_skscore.py. All values are
+ * little endian, strings are an int32 byte count followed by that many UTF-8 bytes.
+ *
+ * Header:
+ *   uint32  Magic 0x43534B53 ("SKSC")
+ *   uint32  Version, 1
+ *   string  MatchId
+ *   string  MapName
+ *
+ * Then one events block per flush:
+ *   uint32  Tag 0x53545645 ("EVTS")
+ *   int32   NumNewVolumes, then NumNewVolumes strings. Volume indices follow the order volume
+ *           names appear in across all blocks, starting at 0
+ *   int32   NumRows, then these columns of NumRows values each:
+ *   float   Time, seconds since the match started
+ *   uint32  VolumeIndex
+ *   int32   SkaterId, the skater's player id or -1 when it has no player state
+ *   float   Speed, in cm/s
+ *   int32   Score
+ *
+ * And a summary block once the match ends:
+ *   uint32  Tag 0x4D4D5553 ("SUMM")
+ *   int32   NumVolumes, then these columns of NumVolumes values each, indexed by volume index:
+ *   int32   Hits
+ *   float   MaxSpeed
+ *   float   MeanSpeed
+ *   uint32  DroppedEvents, events lost because a thread buffer was full
+ */
+UCLASS(Config = Game)
+class SKATEPARK_API UScoreAnalyticsSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UScoreAnalyticsSubsystem();
+
+	virtual void Deinitialize() override;
+
+	void BeginMatch(const FString& MapName);
+
+	void EndMatch();
+
+	/** Safe to call from the scoring hot path, drops the event if no match is being recorded */
+	void RecordScore(const AActor* Volume, const AActor* Skater, int32 Score);
+
+protected:
+	/** Only meant for tuning runs, shipping and regular play never write analytics */
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnabled = false;
+
+	UPROPERTY(Config, EditAnywhere)
+	float FlushIntervalSeconds = 5.f;
+
+	/** Events each thread can hold between two flushes before new ones get dropped */
+	UPROPERTY(Config, EditAnywhere)
+	int32 EventsPerThread = 4096;
+
+private:
+	FScoreEventBuffer& GetThreadBuffer();
+
+	/** Tells apart subsystems that end up at the same address, e.g. across PIE sessions */
+	uint32 InstanceId;
+
+	FCriticalSection BuffersLock;
+	TArray<TUniquePtr<FScoreEventBuffer>> Buffers;
+
+	TUniquePtr<FScoreAnalyticsWriter> Writer;
+
+	std::atomic<bool> bRecording = false;
+	double MatchStartTime;
+};
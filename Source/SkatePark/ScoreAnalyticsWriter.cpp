@@ -0,0 +1,223 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ScoreAnalyticsWriter.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "SkatePark.h"
+
+namespace ScoreAnalytics
+{
+	constexpr uint32 FileMagic = 0x43534B53; // "SKSC"
+	constexpr uint32 FileVersion = 1;
+	constexpr uint32 EventsTag = 0x53545645; // "EVTS"
+	constexpr uint32 SummaryTag = 0x4D4D5553; // "SUMM"
+
+	/** Strings are stored as a byte count followed by UTF-8 so they can be read without the engine */
+	void WriteString(FArchive& Ar, const FString& String)
+	{
+		FTCHARToUTF8 Utf8(*String);
+		int32 Length = Utf8.Length();
+		Ar << Length;
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Length);
+	}
+
+	template<typename T>
+	void WriteColumn(FArchive& Ar, TArray<T>& Column)
+	{
+		Ar.Serialize(Column.GetData(), Column.Num() * sizeof(T));
+	}
+}
+
+FScoreEventBuffer::FScoreEventBuffer(const int32 Capacity, const uint32 InOwnerThreadId)
+	: OwnerThreadId(InOwnerThreadId)
+{
+	Events.SetNum(FMath::Max(Capacity, 1));
+}
+
+bool FScoreEventBuffer::Push(const FScoreEvent& Event)
+{
+	const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+	if (CurrentTail - Head.load(std::memory_order_acquire) >= static_cast<uint32>(Events.Num()))
+	{
+		Dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Events[CurrentTail % Events.Num()] = Event;
+	Tail.store(CurrentTail + 1, std::memory_order_release);
+	return true;
+}
+
+void FScoreEventBuffer::Drain(TArray<FScoreEvent>& OutEvents)
+{
+	const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+	const uint32 CurrentTail = Tail.load(std::memory_order_acquire);
+	for (uint32 Index = CurrentHead; Index != CurrentTail; Index++)
+	{
+		OutEvents.Add(Events[Index % Events.Num()]);
+	}
+	Head.store(CurrentTail, std::memory_order_release);
+}
+
+FScoreAnalyticsWriter::FScoreAnalyticsWriter(const FString& FilePath, const FString& MatchId, const FString& MapName, const float FlushInterval,
+	FCriticalSection& InBuffersLock, const TArray<TUniquePtr<FScoreEventBuffer>>& InBuffers)
+	: BuffersLock(InBuffersLock)
+	, Buffers(InBuffers)
+	, FlushIntervalMs(FMath::Max(FMath::RoundToInt(FlushInterval * 1000.f), 1))
+{
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (FileWriter)
+	{
+		uint32 Magic = ScoreAnalytics::FileMagic;
+		uint32 Version = ScoreAnalytics::FileVersion;
+		*FileWriter << Magic << Version;
+		ScoreAnalytics::WriteString(*FileWriter, MatchId);
+		ScoreAnalytics::WriteString(*FileWriter, MapName);
+	}
+	else
+	{
+		UE_LOG(LogSkatePark, Warning, TEXT("Could not open %s, score analytics for this match are discarded"), *FilePath);
+	}
+
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("ScoreAnalyticsWriter"), 0, TPri_BelowNormal);
+}
+
+FScoreAnalyticsWriter::~FScoreAnalyticsWriter()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+
+	Flush();
+	if (FileWriter)
+	{
+		WriteSummary();
+		FileWriter->Close();
+	}
+}
+
+uint32 FScoreAnalyticsWriter::Run()
+{
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		WakeEvent->Wait(FlushIntervalMs);
+		Flush();
+	}
+	return 0;
+}
+
+void FScoreAnalyticsWriter::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+void FScoreAnalyticsWriter::Flush()
+{
+	{
+		FScopeLock Lock(&BuffersLock);
+		for (const TUniquePtr<FScoreEventBuffer>& Buffer : Buffers)
+		{
+			Buffer->Drain(PendingEvents);
+			DroppedEvents += Buffer->TakeDroppedCount();
+		}
+	}
+
+	if (PendingEvents.IsEmpty() || !FileWriter)
+	{
+		PendingEvents.Reset();
+		return;
+	}
+
+	const int32 NumRows = PendingEvents.Num();
+	TArray<FString> NewVolumes;
+	TArray<float> Times;
+	TArray<uint32> VolumeColumn;
+	TArray<int32> Skaters;
+	TArray<float> Speeds;
+	TArray<int32> Scores;
+	Times.Reserve(NumRows);
+	VolumeColumn.Reserve(NumRows);
+	Skaters.Reserve(NumRows);
+	Speeds.Reserve(NumRows);
+	Scores.Reserve(NumRows);
+
+	for (const FScoreEvent& Event : PendingEvents)
+	{
+		const uint32 VolumeIndex = GetVolumeIndex(Event.Volume, NewVolumes);
+		FVolumeStats& Stats = VolumeStats[VolumeIndex];
+		Stats.Hits++;
+		Stats.MaxSpeed = FMath::Max(Stats.MaxSpeed, Event.Speed);
+		Stats.SpeedSum += Event.Speed;
+
+		Times.Add(Event.Time);
+		VolumeColumn.Add(VolumeIndex);
+		Skaters.Add(Event.SkaterId);
+		Speeds.Add(Event.Speed);
+		Scores.Add(Event.Score);
+	}
+	PendingEvents.Reset();
+
+	uint32 Tag = ScoreAnalytics::EventsTag;
+	int32 NumNewVolumes = NewVolumes.Num();
+	int32 Rows = NumRows;
+	*FileWriter << Tag << NumNewVolumes;
+	for (const FString& Volume : NewVolumes)
+	{
+		ScoreAnalytics::WriteString(*FileWriter, Volume);
+	}
+	*FileWriter << Rows;
+	ScoreAnalytics::WriteColumn(*FileWriter, Times);
+	ScoreAnalytics::WriteColumn(*FileWriter, VolumeColumn);
+	ScoreAnalytics::WriteColumn(*FileWriter, Skaters);
+	ScoreAnalytics::WriteColumn(*FileWriter, Speeds);
+	ScoreAnalytics::WriteColumn(*FileWriter, Scores);
+	FileWriter->Flush();
+}
+
+void FScoreAnalyticsWriter::WriteSummary()
+{
+	TArray<int32> Hits;
+	TArray<float> MaxSpeeds;
+	TArray<float> MeanSpeeds;
+	for (const FVolumeStats& Stats : VolumeStats)
+	{
+		Hits.Add(Stats.Hits);
+		MaxSpeeds.Add(Stats.MaxSpeed);
+		MeanSpeeds.Add(Stats.Hits > 0 ? static_cast<float>(Stats.SpeedSum / Stats.Hits) : 0.f);
+	}
+
+	uint32 Tag = ScoreAnalytics::SummaryTag;
+	int32 NumVolumes = VolumeStats.Num();
+	*FileWriter << Tag << NumVolumes;
+	ScoreAnalytics::WriteColumn(*FileWriter, Hits);
+	ScoreAnalytics::WriteColumn(*FileWriter, MaxSpeeds);
+	ScoreAnalytics::WriteColumn(*FileWriter, MeanSpeeds);
+	*FileWriter << DroppedEvents;
+
+	if (DroppedEvents > 0)
+	{
+		UE_LOG(LogSkatePark, Warning, TEXT("Score analytics dropped %u events, raise EventsPerThread or lower FlushIntervalSeconds"), DroppedEvents);
+	}
+}
+
+uint32 FScoreAnalyticsWriter::GetVolumeIndex(const FName Volume, TArray<FString>& OutNewVolumes)
+{
+	if (const uint32* Index = VolumeIndices.Find(Volume))
+	{
+		return *Index;
+	}
+
+	const uint32 Index = VolumeStats.AddDefaulted();
+	VolumeIndices.Add(Volume, Index);
+	OutNewVolumes.Add(Volume.ToString());
+	return Index;
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+struct FScoreEvent
+{
+	FName Volume;
+	int32 SkaterId = INDEX_NONE;
+	float Time = 0.f;
+	float Speed = 0.f;
+	int32 Score = 0;
+};
+
+/**
+ * Single producer single consumer ring of score events, written by the thread that owns it
+ * and drained by the analytics writer thread without taking a lock
+ */
+class FScoreEventBuffer
+{
+public:
+	FScoreEventBuffer(int32 Capacity, uint32 InOwnerThreadId);
+
+	uint32 GetOwnerThreadId() const { return OwnerThreadId; }
+
+	/** Producer side, returns false and counts the event as dropped when the ring is full */
+	bool Push(const FScoreEvent& Event);
+
+	/** Consumer side, appends everything pushed so far to OutEvents */
+	void Drain(TArray<FScoreEvent>& OutEvents);
+
+	uint32 TakeDroppedCount() { return Dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+	TArray<FScoreEvent> Events;
+	uint32 OwnerThreadId;
+	std::atomic<uint32> Head = 0;
+	std::atomic<uint32> Tail = 0;
+	std::atomic<uint32> Dropped = 0;
+};
+
+/**
+ * Background thread writing the score events of one match to a columnar file, see UScoreAnalyticsSubsystem
+ */
+class FScoreAnalyticsWriter : public FRunnable
+{
+public:
+	FScoreAnalyticsWriter(const FString& FilePath, const FString& MatchId, const FString& MapName, float FlushInterval,
+		FCriticalSection& InBuffersLock, const TArray<TUniquePtr<FScoreEventBuffer>>& InBuffers);
+
+	/** Stops the thread, writes what is left plus the per volume summary and closes the file */
+	virtual ~FScoreAnalyticsWriter() override;
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void Flush();
+	void WriteSummary();
+	uint32 GetVolumeIndex(FName Volume, TArray<FString>& OutNewVolumes);
+
+	struct FVolumeStats
+	{
+		int32 Hits = 0;
+		float MaxSpeed = 0.f;
+		double SpeedSum = 0.0;
+	};
+
+	FCriticalSection& BuffersLock;
+	const TArray<TUniquePtr<FScoreEventBuffer>>& Buffers;
+
+	TUniquePtr<FArchive> FileWriter;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping = false;
+	uint32 FlushIntervalMs;
+
+	// Only touched by the writer thread, and by the destructor once it has joined
+	TArray<FScoreEvent> PendingEvents;
+	TMap<FName, uint32> VolumeIndices;
+	TArray<FVolumeStats> VolumeStats;
+	uint32 DroppedEvents = 0;
+};
@@ -3,6 +3,7 @@
 
 #include "ScoreVolume.h"
 
+#include "ScoreAnalyticsSubsystem.h"
 #include "ScoreSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "GameFramework/Character.h"
@@ -26,6 +27,10 @@ void AScoreVolume::OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AAct
 			FString Message = ScoreMessage.ToString();
 			ScoreSubsystem->AddScore(Score, Message);
 		}
+		if (UScoreAnalyticsSubsystem* ScoreAnalytics = GetGameInstance()->GetSubsystem<UScoreAnalyticsSubsystem>())
+		{
+			ScoreAnalytics->RecordScore(this, OtherActor, Score);
+		}
 	}
 }
 
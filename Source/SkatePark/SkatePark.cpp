@@ -3,4 +3,6 @@
 #include "SkatePark.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogSkatePark);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, SkatePark, "SkatePark" );
@@ -4,3 +4,6 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogSkatePark, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("SkatePark"), STATGROUP_SkatePark, STATCAT_Advanced);
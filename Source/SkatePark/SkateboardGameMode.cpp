@@ -3,10 +3,66 @@
 
 #include "SkateboardGameMode.h"
 
+#include "ActorPoolSubsystem.h"
+#include "ScoreAnalyticsSubsystem.h"
+#include "SkatePark.h"
+#include "SkateboarderBotCharacter.h"
+#include "SkateboarderBotController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+static FAutoConsoleCommandWithWorldAndArgs StressRespawnLoadTestBotsCommand(
+	TEXT("SkatePark.StressRespawnLoadTestBots"),
+	TEXT("Bails and respawns the load test bots. Arguments: [Respawns=1000] [UsePool=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		ASkateboardGameMode* GameMode = World ? Cast<ASkateboardGameMode>(World->GetAuthGameMode()) : nullptr;
+		if (!GameMode)
+		{
+			UE_LOG(LogSkatePark, Warning, TEXT("SkatePark.StressRespawnLoadTestBots needs a world running ASkateboardGameMode"));
+			return;
+		}
+		const int32 Respawns = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 1000;
+		const bool bUsePool = Args.IsValidIndex(1) ? FCString::ToBool(*Args[1]) : true;
+		GameMode->StressRespawnLoadTestBots(Respawns, bUsePool);
+	}));
+
+ASkateboardGameMode::ASkateboardGameMode()
+{
+	LoadTestBotPawnClass = ASkateboarderBotCharacter::StaticClass();
+	LoadTestBotControllerClass = ASkateboarderBotController::StaticClass();
+}
+
+void ASkateboardGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	LoadTestBotCount = UGameplayStatics::GetIntOption(Options, TEXT("LoadTestBots"), LoadTestBotCount);
+}
+
+bool ASkateboardGameMode::ReadyToStartMatch_Implementation()
+{
+	// A headless load test server has nobody connected, the bots only spawn once the match starts
+	if (LoadTestBotCount > 0 && !bDelayedStart && GetMatchState() == MatchState::WaitingToStart)
+	{
+		return true;
+	}
+	return Super::ReadyToStartMatch_Implementation();
+}
+
 void ASkateboardGameMode::StartMatch()
 {
 	Super::StartMatch();
 
+	if (UScoreAnalyticsSubsystem* ScoreAnalytics = GetGameInstance()->GetSubsystem<UScoreAnalyticsSubsystem>())
+	{
+		ScoreAnalytics->BeginMatch(GetWorld()->GetMapName());
+	}
+
+	SpawnLoadTestBots();
+
 	CurrentMatchTime = MatchDuration;
 	UpdateMatchTimer();
 	GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &ASkateboardGameMode::UpdateMatchTimer, 1, true);
@@ -15,6 +71,10 @@ void ASkateboardGameMode::StartMatch()
 void ASkateboardGameMode::EndMatch()
 {
 	OnMatchFinished.Broadcast();
+	if (UScoreAnalyticsSubsystem* ScoreAnalytics = GetGameInstance()->GetSubsystem<UScoreAnalyticsSubsystem>())
+	{
+		ScoreAnalytics->EndMatch();
+	}
 	Super::EndMatch();
 }
 
@@ -28,3 +88,136 @@ void ASkateboardGameMode::UpdateMatchTimer()
 		TimerHandle.Invalidate();
 	}
 }
+
+void ASkateboardGameMode::SpawnLoadTestBots()
+{
+	UActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<UActorPoolSubsystem>();
+	if (LoadTestBotCount <= 0 || !GetLoadTestBotClass() || !ActorPool)
+	{
+		return;
+	}
+
+	const AActor* Start = FindPlayerStart(nullptr);
+	const FTransform Origin = Start ? Start->GetActorTransform() : FTransform::Identity;
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(LoadTestBotCount)));
+
+	const int64 UsedMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	ActorPool->Prewarm(GetLoadTestBotClass(), LoadTestBotCount);
+	for (int32 Index = 0; Index < LoadTestBotCount; Index++)
+	{
+		const FVector Offset((Index / GridSize + 1) * LoadTestBotSpacing, (Index % GridSize - GridSize / 2) * LoadTestBotSpacing, 0);
+		if (APawn* Bot = AcquireLoadTestBot(FTransform(Origin.GetRotation(), Origin.TransformPosition(Offset))))
+		{
+			LoadTestBots.Add(Bot);
+		}
+	}
+	const int64 UsedMemoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+
+	// The native bot class has no meshes, the numbers below would understate what a real skater costs
+	const ACharacter* FirstBot = LoadTestBots.IsEmpty() ? nullptr : Cast<ACharacter>(LoadTestBots[0]);
+	if (FirstBot && (!FirstBot->GetMesh() || !FirstBot->GetMesh()->GetSkeletalMeshAsset()))
+	{
+		UE_LOG(LogSkatePark, Warning, TEXT("Load test bot %s has no skeletal mesh, set LoadTestBotPawnClass to a Blueprint child of ASkateboarderBotCharacter using the skater meshes and anim Blueprint"),
+			*GetNameSafe(GetLoadTestBotClass()));
+	}
+
+	// Pair with "stat SkatePark" to get the skater tick cost per bot
+	UE_LOG(LogSkatePark, Log, TEXT("Spawned %d load test bots, %.1f KB resident memory per skater"),
+		LoadTestBots.Num(), LoadTestBots.Num() > 0 ? static_cast<double>(UsedMemoryAfter - UsedMemoryBefore) / LoadTestBots.Num() / 1024.0 : 0.0);
+}
+
+TSubclassOf<APawn> ASkateboardGameMode::GetLoadTestBotClass() const
+{
+	return LoadTestBotPawnClass ? LoadTestBotPawnClass : DefaultPawnClass;
+}
+
+APawn* ASkateboardGameMode::AcquireLoadTestBot(const FTransform& SpawnTransform)
+{
+	APawn* Bot = GetWorld()->GetSubsystem<UActorPoolSubsystem>()->AcquireActor<APawn>(GetLoadTestBotClass(), SpawnTransform);
+	if (Bot && !Bot->GetController())
+	{
+		Bot->AIControllerClass = LoadTestBotControllerClass;
+		Bot->SpawnDefaultController();
+	}
+	return Bot;
+}
+
+APawn* ASkateboardGameMode::RespawnLoadTestBot(APawn* Bot, const bool bUsePool)
+{
+	const FTransform SpawnTransform = Bot->GetActorTransform();
+	if (bUsePool)
+	{
+		GetWorld()->GetSubsystem<UActorPoolSubsystem>()->ReleaseActor(Bot);
+		return AcquireLoadTestBot(SpawnTransform);
+	}
+
+	// What a respawn costs without the pool: a fresh pawn and controller, the old ones left to the garbage collector.
+	// Bots have a player state, so destroying the pawn alone would leave its controller alive
+	if (AController* Controller = Bot->GetController())
+	{
+		Controller->UnPossess();
+		Controller->Destroy();
+	}
+	Bot->Destroy();
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APawn* NewBot = GetWorld()->SpawnActor<APawn>(GetLoadTestBotClass(), SpawnTransform, SpawnParams);
+	if (NewBot)
+	{
+		NewBot->AIControllerClass = LoadTestBotControllerClass;
+		NewBot->SpawnDefaultController();
+	}
+	return NewBot;
+}
+
+void ASkateboardGameMode::StressRespawnLoadTestBots(const int32 Respawns, const bool bUsePool)
+{
+	LoadTestBots.RemoveAll([](const APawn* Bot) { return !IsValid(Bot); });
+	if (Respawns <= 0 || LoadTestBots.IsEmpty() || StressRespawnsRemaining > 0)
+	{
+		return;
+	}
+
+	// Start from a clean heap so the collection at the end only pays for this run's garbage
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	StressRespawnsRemaining = Respawns;
+	StressRespawnsDone = 0;
+	bStressRespawnUsePool = bUsePool;
+	StressRespawnTime = 0.0;
+	StressRespawnObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	GetWorldTimerManager().SetTimerForNextTick(this, &ASkateboardGameMode::StressRespawnStep);
+}
+
+void ASkateboardGameMode::StressRespawnStep()
+{
+	LoadTestBots.RemoveAll([](const APawn* Bot) { return !IsValid(Bot); });
+
+	// Every bot bails and respawns once per frame, like a crowded park would over a few seconds
+	const int32 FrameRespawns = FMath::Min(StressRespawnsRemaining, LoadTestBots.Num());
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 BotIndex = 0; BotIndex < FrameRespawns; BotIndex++)
+	{
+		LoadTestBots[BotIndex] = RespawnLoadTestBot(LoadTestBots[BotIndex], bStressRespawnUsePool);
+	}
+	StressRespawnTime += FPlatformTime::Seconds() - StartTime;
+	StressRespawnsDone += FrameRespawns;
+	StressRespawnsRemaining -= FrameRespawns;
+
+	if (StressRespawnsRemaining > 0 && FrameRespawns > 0)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ASkateboardGameMode::StressRespawnStep);
+		return;
+	}
+	StressRespawnsRemaining = 0;
+	LoadTestBots.RemoveAll([](const APawn* Bot) { return !IsValid(Bot); });
+
+	const int32 ObjectsCreated = GUObjectArray.GetObjectArrayNumMinusAvailable() - StressRespawnObjectsBefore;
+	const double GCStartTime = FPlatformTime::Seconds();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	const double GCTime = FPlatformTime::Seconds() - GCStartTime;
+
+	UE_LOG(LogSkatePark, Log, TEXT("%s: respawned %d load test bots in %.2f ms (%.1f us each), %d UObjects created, garbage collection took %.2f ms"),
+		bStressRespawnUsePool ? TEXT("Pooled") : TEXT("Not pooled"), StressRespawnsDone, StressRespawnTime * 1000.0,
+		StressRespawnsDone > 0 ? StressRespawnTime * 1000000.0 / StressRespawnsDone : 0.0, ObjectsCreated, GCTime * 1000.0);
+}
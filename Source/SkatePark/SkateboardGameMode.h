@@ -18,20 +18,64 @@ class SKATEPARK_API ASkateboardGameMode : public AGameMode
 	GENERATED_BODY()
 
 public:
+	ASkateboardGameMode();
+
 	UFUNCTION(BlueprintCallable)
 	int32 GetMatchDuration() const { return MatchDuration; }
 
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	virtual bool ReadyToStartMatch_Implementation() override;
 	virtual void StartMatch() override;
 	virtual void EndMatch() override;
 
+	/**
+	 * Bails and respawns every load test bot once per frame until Respawns is reached, through the actor pool or
+	 * with a plain destroy and spawn, then logs the respawn cost and how long collecting the garbage took.
+	 * Run it with the SkatePark.StressRespawnLoadTestBots console command, which a dedicated server console reaches too
+	 */
+	void StressRespawnLoadTestBots(int32 Respawns = 1000, bool bUsePool = true);
+
 	FOnUpdateMatchTime OnUpdateMatchTime;
 	FOnMatchFinished OnMatchFinished;
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	int32 MatchDuration = 180;
+
+	/** Bot skaters spawned when the match starts, overridden with ?LoadTestBots=N on the URL */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = LoadTest)
+	int32 LoadTestBotCount = 0;
+
+	/** Pawn used for the bots, falls back to DefaultPawnClass when empty. ASkateboarderBotCharacter has no meshes, use a Blueprint child of it to see the bots */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = LoadTest)
+	TSubclassOf<APawn> LoadTestBotPawnClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = LoadTest)
+	TSubclassOf<AController> LoadTestBotControllerClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = LoadTest)
+	float LoadTestBotSpacing = 150.f;
 	
 private:
+	void SpawnLoadTestBots();
+
+	TSubclassOf<APawn> GetLoadTestBotClass() const;
+
+	APawn* AcquireLoadTestBot(const FTransform& SpawnTransform);
+
+	APawn* RespawnLoadTestBot(APawn* Bot, bool bUsePool);
+
+	void StressRespawnStep();
+
+	UPROPERTY()
+	TArray<APawn*> LoadTestBots;
+
+	int32 StressRespawnsRemaining;
+	int32 StressRespawnsDone;
+	bool bStressRespawnUsePool;
+	double StressRespawnTime;
+	int32 StressRespawnObjectsBefore;
+
 	UPROPERTY()
 	FTimerHandle TimerHandle;
 
@@ -0,0 +1,11 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SkateboarderBotCharacter.h"
+
+ASkateboarderBotCharacter::ASkateboarderBotCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.DoNotCreateDefaultSubobject(TEXT("CameraBoom"))
+		.DoNotCreateDefaultSubobject(TEXT("FollowCamera")))
+{
+}
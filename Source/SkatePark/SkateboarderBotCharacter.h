@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkateboarderCharacter.h"
+#include "SkateboarderBotCharacter.generated.h"
+
+/**
+ * Skater for bots and ghosts, nobody looks through it so it is built without the camera boom and follow camera
+ */
+UCLASS()
+class SKATEPARK_API ASkateboarderBotCharacter : public ASkateboarderCharacter
+{
+	GENERATED_BODY()
+
+public:
+	ASkateboarderBotCharacter(const FObjectInitializer& ObjectInitializer);
+};
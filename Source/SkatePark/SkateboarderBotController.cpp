@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SkateboarderBotController.h"
+
+#include "SkateboarderCharacter.h"
+
+ASkateboarderBotController::ASkateboarderBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// Gives bots a player id, which is how score analytics tells skaters apart
+	bWantsPlayerState = true;
+
+	// Push, carve both ways and ollie so every skater code path gets exercised
+	const auto AddStep = [this](const FVector2D& MoveInput, const bool bJump, const float Duration)
+	{
+		FBotInputStep& Step = InputScript.AddDefaulted_GetRef();
+		Step.MoveInput = MoveInput;
+		Step.bJump = bJump;
+		Step.Duration = Duration;
+	};
+	AddStep(FVector2D(0.f, 1.f), false, 1.5f);
+	AddStep(FVector2D(1.f, 0.f), false, 1.f);
+	AddStep(FVector2D(0.f, 1.f), true, 0.5f);
+	AddStep(FVector2D(-1.f, 0.f), false, 1.f);
+	AddStep(FVector2D(0.f, -0.5f), false, 0.5f);
+}
+
+void ASkateboarderBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	// Desync the bots so they don't all jump on the same frame
+	CurrentStep = FMath::RandHelper(FMath::Max(InputScript.Num(), 1));
+	StepTimeRemaining = InputScript.IsValidIndex(CurrentStep) ? FMath::FRandRange(0.f, InputScript[CurrentStep].Duration) : 0.f;
+}
+
+void ASkateboarderBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ASkateboarderCharacter* Skateboarder = Cast<ASkateboarderCharacter>(GetPawn());
+	if (!Skateboarder || InputScript.IsEmpty())
+	{
+		return;
+	}
+
+	StepTimeRemaining -= DeltaSeconds;
+	if (StepTimeRemaining <= 0)
+	{
+		AdvanceStep();
+		if (InputScript[CurrentStep].bJump)
+		{
+			Skateboarder->JumpPressed();
+			Skateboarder->JumpReleased();
+		}
+	}
+
+	// Held inputs are applied every frame, like the Move action while it is triggered
+	Skateboarder->ApplyMoveInput(InputScript[CurrentStep].MoveInput);
+}
+
+void ASkateboarderBotController::AdvanceStep()
+{
+	CurrentStep = (CurrentStep + 1) % InputScript.Num();
+	StepTimeRemaining += InputScript[CurrentStep].Duration;
+}
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "SkateboarderBotController.generated.h"
+
+USTRUCT(BlueprintType)
+struct FBotInputStep
+{
+	GENERATED_BODY()
+
+	/** Same layout as the Move action, X steers and Y pushes or brakes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FVector2D MoveInput = FVector2D::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bJump = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float Duration = 1.f;
+};
+
+/**
+ * Drives a skateboarder with a looping input script, used to load test servers
+ */
+UCLASS()
+class SKATEPARK_API ASkateboarderBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	ASkateboarderBotController();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TArray<FBotInputStep> InputScript;
+
+private:
+	void AdvanceStep();
+
+	int32 CurrentStep;
+
+	float StepTimeRemaining;
+};
@@ -2,16 +2,31 @@
 
 
 #include "SkateboarderCharacter.h"
+#include "SkatePark.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "HAL/IConsoleManager.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 
+DECLARE_CYCLE_STAT(TEXT("Skateboarder Tick"), STAT_SkateboarderTick, STATGROUP_SkatePark);
+DECLARE_CYCLE_STAT(TEXT("Skateboarder Wall Check"), STAT_SkateboarderWallCheck, STATGROUP_SkatePark);
+DECLARE_CYCLE_STAT(TEXT("Skateboarder Legacy Wall Check"), STAT_SkateboarderLegacyWallCheck, STATGROUP_SkatePark);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wall Sweeps"), STAT_SkateboarderWallSweeps, STATGROUP_SkatePark);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wall Sweeps Skipped"), STAT_SkateboarderWallSweepsSkipped, STATGROUP_SkatePark);
+
+static TAutoConsoleVariable<bool> CVarLegacyWallCheck(
+	TEXT("SkatePark.LegacyWallCheck"),
+	false,
+	TEXT("Use the old fixed two ray wall check instead of the swept capsule, to compare their cost"),
+	ECVF_Cheat);
+
 // Sets default values
-ASkateboarderCharacter::ASkateboarderCharacter()
+ASkateboarderCharacter::ASkateboarderCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
@@ -31,16 +46,28 @@ ASkateboarderCharacter::ASkateboarderCharacter()
 	GetCharacterMovement()->BrakingDecelerationWalking = 0.f;
 	GetCharacterMovement()->BrakingDecelerationFalling = 0.0f;
 
+#if !UE_SERVER
 	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-	CameraBoom->SetupAttachment(RootComponent);
-	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
-	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+	// Optional so skaters nobody looks through, like ASkateboarderBotCharacter, can skip it
+	CameraBoom = CreateOptionalDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	if (CameraBoom)
+	{
+		CameraBoom->SetupAttachment(RootComponent);
+		CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
+		CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+	}
 
 	// Create a follow camera
-	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
-	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	FollowCamera = CreateOptionalDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+	if (FollowCamera)
+	{
+		FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
+		FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	}
+#else
+	// Nothing is ever rendered on a dedicated server, so don't pay for pose evaluation
+	GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+#endif
 
 	SkateboardMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("SkateboardMesh"));
 	SkateboardMesh->SetupAttachment(GetRootComponent());
@@ -56,6 +83,26 @@ FVector ASkateboarderCharacter::GetRightFootSocketLocation() const
 	return GetAdjustedLocation(SkateboardMesh->GetSocketTransform(SkateboardRightFootSocketName, RTS_Component));
 }
 
+void ASkateboarderCharacter::ResetSkaterState()
+{
+	Inertia = 0;
+	CurrentSlope = 0;
+	bPreparingJump = false;
+	bHasClearPath = false;
+	PendingBounceSpeed = 0;
+	GetCharacterMovement()->StopMovementImmediately();
+}
+
+void ASkateboarderCharacter::OnAcquiredFromPool()
+{
+	ResetSkaterState();
+}
+
+void ASkateboarderCharacter::OnReleasedToPool()
+{
+	ResetSkaterState();
+}
+
 void ASkateboarderCharacter::OnConstruction(const FTransform& Transform)
 {
 	GetMesh()->AttachToComponent(SkateboardMesh, FAttachmentTransformRules::KeepRelativeTransform);
@@ -89,8 +136,85 @@ void ASkateboarderCharacter::CalculateSlope()
 	CurrentSlope = Cat / Hip;
 }
 
-void ASkateboarderCharacter::WallCheck()
+float ASkateboarderCharacter::WallCheck(const float DeltaSeconds)
+{
+	if (CVarLegacyWallCheck.GetValueOnGameThread())
+	{
+		LegacyWallCheck();
+		return 1.f;
+	}
+	return SweepWallCheck(DeltaSeconds);
+}
+
+float ASkateboarderCharacter::SweepWallCheck(const float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SkateboarderWallCheck);
+
+	// Sweep the upper part of the capsule so the ground and curbs we can step onto don't count as walls
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+	const float Radius = Capsule->GetScaledCapsuleRadius();
+	const float HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	const float SweepHalfHeight = FMath::Max(HalfHeight - GetCharacterMovement()->MaxStepHeight * 0.5f, Radius);
+	const FVector Start = GetActorLocation() + GetActorUpVector() * (HalfHeight - SweepHalfHeight);
+	const FVector Direction = GetActorForwardVector();
+
+	// Speed scaled so the board can't get past a thin wall between two frames however fast it goes
+	const float FrameDistance = GetVelocity().Size() * DeltaSeconds;
+	const float RequiredDistance = FrameDistance + WallProbeDistance;
+	if (IsPathCachedClear(Start, Direction, RequiredDistance))
+	{
+		INC_DWORD_STAT(STAT_SkateboarderWallSweepsSkipped);
+		return 1.f;
+	}
+
+	INC_DWORD_STAT(STAT_SkateboarderWallSweeps);
+	const FVector End = Start + Direction * (FrameDistance * WallSweepLookahead + WallProbeDistance);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SkateboarderWallCheck), false, this);
+	// A side wall we brush against, or the wall we just bounced off, must not hide the one ahead
+	QueryParams.bFindInitialOverlaps = false;
+	FHitResult Hit;
+	if (!GetWorld()->SweepSingleByChannel(Hit, Start, End, GetActorQuat(), ECC_WorldStatic, FCollisionShape::MakeCapsule(Radius, SweepHalfHeight), QueryParams))
+	{
+		ClearPathStart = Start;
+		ClearPathEnd = End;
+		bHasClearPath = true;
+		return 1.f;
+	}
+
+	// Anything we can ride up is a ramp, and a wall further than this frame's reach is handled once we get there
+	bHasClearPath = false;
+	if (Hit.bStartPenetrating || GetCharacterMovement()->IsWalkable(Hit) || Hit.Distance > RequiredDistance)
+	{
+		return 1.f;
+	}
+
+	// Resolve at the time of impact: move to the contact, only the rest of this frame's travel goes along the reflection
+	float RemainingFraction = 1.f;
+	if (Hit.Distance < FrameDistance)
+	{
+		SetActorLocation(GetActorLocation() + Direction * Hit.Distance);
+		RemainingFraction = 1.f - Hit.Distance / FrameDistance;
+	}
+
+	const float Dot = Direction.Dot(Hit.ImpactNormal);
+	const float Restitution = -Dot * 0.5f;
+	Inertia *= Restitution;
+
+	// The movement component moves a full frame of velocity after us, so it only gets the remaining part of it
+	// and the full bounce speed is given back at the start of the next tick
+	const FVector BounceVelocity = GetCharacterMovement()->Velocity.MirrorByVector(Hit.ImpactNormal) * Restitution;
+	GetCharacterMovement()->Velocity = BounceVelocity * RemainingFraction;
+	PendingBounceSpeed = RemainingFraction < 1.f ? BounceVelocity.Size() : 0.f;
+	
+	const FVector MirrorVector = Direction.MirrorByVector(Hit.ImpactNormal);
+	SetActorRotation(MirrorVector.Rotation());
+	return RemainingFraction;
+}
+
+void ASkateboarderCharacter::LegacyWallCheck()
 {
+	SCOPE_CYCLE_COUNTER(STAT_SkateboarderLegacyWallCheck);
+
 	const FVector HighStartVector = GetActorLocation() + GetActorForwardVector() * 50 + GetActorUpVector() * 50;
 	const FVector LowStartVector = GetActorLocation() + GetActorForwardVector() * 50 - GetActorUpVector() * 50;
 	const FVector DistTest = GetActorForwardVector() * 10;
@@ -111,11 +235,38 @@ void ASkateboarderCharacter::WallCheck()
 	
 }
 
+bool ASkateboarderCharacter::IsPathCachedClear(const FVector& Start, const FVector& Direction, const float Distance) const
+{
+	if (!bHasClearPath)
+	{
+		return false;
+	}
+
+	const FVector ClearPath = ClearPathEnd - ClearPathStart;
+	const float ClearDistance = ClearPath.Size();
+	if (ClearDistance <= KINDA_SMALL_NUMBER || Direction.Dot(ClearPath / ClearDistance) < 0.9999f)
+	{
+		return false;
+	}
+
+	// Still on the cached line, and the part needed this frame doesn't reach past its end
+	return FMath::PointDistToSegment(Start, ClearPathStart, ClearPathEnd) <= WallSweepCacheTolerance
+		&& (Start - ClearPathStart).Dot(Direction) + Distance <= ClearDistance;
+}
+
 void ASkateboarderCharacter::Tick(float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_SkateboarderTick);
 	Super::Tick(DeltaSeconds);
 
-	WallCheck();
+	if (PendingBounceSpeed > 0)
+	{
+		FVector& Velocity = GetCharacterMovement()->Velocity;
+		Velocity = (Velocity.IsNearlyZero() ? GetActorForwardVector() : Velocity.GetSafeNormal()) * PendingBounceSpeed;
+		PendingBounceSpeed = 0;
+	}
+
+	const float RemainingFraction = WallCheck(DeltaSeconds);
 	CalculateSlope();
 	FRotator ActorRotation = GetActorRotation();
 	float SlopeAngle = FMath::RadiansToDegrees(FMath::Asin(CurrentSlope));
@@ -125,7 +276,7 @@ void ASkateboarderCharacter::Tick(float DeltaSeconds)
 	
 	AddMovement(-CurrentSlope * SlopeGravityIntensity * DeltaSeconds);
 
-	AddMovementInput(GetActorForwardVector(), Inertia * DeltaSeconds);
+	AddMovementInput(GetActorForwardVector(), Inertia * DeltaSeconds * RemainingFraction);
 	
 	if (GetMovementComponent()->IsMovingOnGround())
 	{
@@ -204,7 +355,11 @@ void ASkateboarderCharacter::RotateActorAroundUpVector(const float Angle)
 void ASkateboarderCharacter::Move(const FInputActionValue& Value)
 {
 	// input is a Vector2D
-	const FVector2D MovementVector = Value.Get<FVector2D>();
+	ApplyMoveInput(Value.Get<FVector2D>());
+}
+
+void ASkateboarderCharacter::ApplyMoveInput(const FVector2D& MovementVector)
+{
 	if (GetMovementComponent()->IsMovingOnGround())
 	{
 		if (MovementVector.Y != 0)
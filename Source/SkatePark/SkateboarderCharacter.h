@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "PoolableActor.h"
 #include "SkateboarderCharacter.generated.h"
 
 class USpringArmComponent;
@@ -13,7 +14,7 @@ class UInputAction;
 struct FInputActionValue;
 
 UCLASS()
-class SKATEPARK_API ASkateboarderCharacter : public ACharacter
+class SKATEPARK_API ASkateboarderCharacter : public ACharacter, public IPoolableActor
 {
 	GENERATED_BODY()
 
@@ -73,10 +74,22 @@ class SKATEPARK_API ASkateboarderCharacter : public ACharacter
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Defaults, meta = (AllowPrivateAccess = "true"))
 	float MaxMovement = 100.f;
+
+	/** Distance kept clear in front of the board on top of the distance travelled this frame */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Defaults, meta = (AllowPrivateAccess = "true"))
+	float WallProbeDistance = 20.f;
+
+	/** How many frames of travel the wall sweep looks ahead, the clear part is reused on the next frames */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Defaults, meta = (AllowPrivateAccess = "true"))
+	float WallSweepLookahead = 4.f;
+
+	/** Sideways drift allowed before the cached clear path is swept again */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Defaults, meta = (AllowPrivateAccess = "true"))
+	float WallSweepCacheTolerance = 2.f;
 	
 public:
 	// Sets default values for this pawn's properties
-	ASkateboarderCharacter();
+	ASkateboarderCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	UFUNCTION(BlueprintPure)
 	FVector GetLeftFootSocketLocation() const;
@@ -84,13 +97,32 @@ public:
 	UFUNCTION(BlueprintPure)
 	FVector GetRightFootSocketLocation() const;
 
+	/** Pushes, brakes and steers the board, X steers and Y pushes (positive) or brakes (negative) */
+	void ApplyMoveInput(const FVector2D& MovementVector);
+
+	void JumpPressed();
+
+	void JumpReleased();
+
+	/** Clears board speed, slope and jump state, e.g. when respawning after a bail */
+	void ResetSkaterState();
+
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+
 protected:
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 	
 	void CalculateSlope();
 
-	void WallCheck();
+	/** Bounces the board off walls ahead, returns the fraction of this frame's travel left after the bounce */
+	float WallCheck(float DeltaSeconds);
+
+	float SweepWallCheck(float DeltaSeconds);
+
+	/** The original fixed two ray check, kept behind SkatePark.LegacyWallCheck for cost comparisons */
+	void LegacyWallCheck();
 
 	virtual void Tick(float DeltaSeconds) override;
 	
@@ -100,10 +132,6 @@ protected:
 	/** Called for looking input */
 	void Look(const FInputActionValue& Value);
 
-	void JumpPressed();
-
-	void JumpReleased();
-
 	virtual void NotifyControllerChanged() override;
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -113,7 +141,18 @@ private:
 	void AddMovement(float Amount);
 	void Brake(float Amount);
 	void RotateActorAroundUpVector(float Angle);
+	bool IsPathCachedClear(const FVector& Start, const FVector& Direction, float Distance) const;
 	float Inertia;
+
+	/** Last wall sweep that found nothing, in sweep start space */
+	FVector ClearPathStart;
+	FVector ClearPathEnd;
+	bool bHasClearPath;
+
+	/** Speed to give back after a bounce that only used part of the frame */
+	float PendingBounceSpeed;
+
+	friend class FSkateboarderWallCheckCostTest;
 	
 public:
 	/** Returns CameraBoom subobject **/
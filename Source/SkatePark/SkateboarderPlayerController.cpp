@@ -9,5 +9,11 @@ void ASkateboarderPlayerController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
 
-	Cast<AGameHUD>(GetHUD())->InitializeHUD();
+#if !UE_SERVER
+	// Only the owning client has a HUD, the server possesses remote players' pawns as well
+	if (AGameHUD* GameHUD = Cast<AGameHUD>(GetHUD()))
+	{
+		GameHUD->InitializeHUD();
+	}
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AIController.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "SkateboarderCharacter.h"
+
+namespace SkateboarderWallCheckTests
+{
+	constexpr float WallX = 1000.f;
+	constexpr float WallThickness = 5.f;
+
+	/** Bare game world with a floor and a thin wall across the skater's path */
+	class FTestWorld
+	{
+	public:
+		FTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+
+			// UWorld::BeginPlay goes through the game mode, which this bare world doesn't have. Begin play on the
+			// world settings directly so actors get BeginPlay and their tick functions registered
+			World->GetWorldSettings()->NotifyBeginPlay();
+			check(World->HasBegunPlay());
+
+			SpawnBox(FVector(0.f, 0.f, -50.f), FVector(50.f, 50.f, 1.f));
+			SpawnBox(FVector(WallX, 0.f, 250.f), FVector(WallThickness / 100.f, 10.f, 5.f));
+		}
+
+		~FTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		/** Skater on the floor facing the wall, possessed so its movement component simulates */
+		ASkateboarderCharacter* SpawnSkater() const
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			ASkateboarderCharacter* Skater = World->SpawnActor<ASkateboarderCharacter>(FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+			if (Skater)
+			{
+				Skater->AIControllerClass = AAIController::StaticClass();
+				Skater->SpawnDefaultController();
+			}
+			return Skater;
+		}
+
+		void Tick(const float DeltaSeconds) const
+		{
+			World->Tick(LEVELTICK_All, DeltaSeconds);
+		}
+
+	private:
+		void SpawnBox(const FVector& Location, const FVector& Scale) const
+		{
+			const FTransform Transform(FRotator::ZeroRotator, Location, Scale);
+			if (AStaticMeshActor* Box = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform))
+			{
+				Box->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+			}
+		}
+
+		UWorld* World;
+	};
+
+	/**
+	 * Pushes the skater into the wall at a fixed frame rate. The bounce must happen on the frame the capsule
+	 * would reach the wall, before the movement component's own sweep stops it, and leave it moving away
+	 */
+	bool RunBounceTest(FAutomationTestBase& Test, const float FrameRate)
+	{
+		const FTestWorld TestWorld;
+		ASkateboarderCharacter* Skater = TestWorld.SpawnSkater();
+		if (!Test.TestNotNull(TEXT("Skater"), Skater))
+		{
+			return false;
+		}
+
+		const float DeltaSeconds = 1.f / FrameRate;
+		const float Radius = Skater->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		const float ContactX = WallX - WallThickness * 0.5f - Radius;
+		for (int32 Frame = 0; Frame < FMath::CeilToInt(FrameRate * 6.f); Frame++)
+		{
+			const float ReachX = Skater->GetActorLocation().X + FMath::Max(Skater->GetVelocity().X, 0.f) * DeltaSeconds;
+			Skater->ApplyMoveInput(FVector2D(0.f, 1.f));
+			TestWorld.Tick(DeltaSeconds);
+
+			if (Skater->GetActorForwardVector().X < 0.f)
+			{
+				Test.TestTrue(FString::Printf(TEXT("Skater moves away from the wall after bouncing on frame %d"), Frame), Skater->GetVelocity().X <= KINDA_SMALL_NUMBER);
+				Test.TestTrue(TEXT("Skater is on the near side of the wall after bouncing"), Skater->GetActorLocation().X <= ContactX + 1.f);
+				return true;
+			}
+
+			if (ReachX >= ContactX)
+			{
+				Test.AddError(FString::Printf(TEXT("Skater reached the wall on frame %d at %.0f fps without bouncing"), Frame, FrameRate));
+				return false;
+			}
+		}
+
+		Test.AddError(FString::Printf(TEXT("Skater never bounced off the wall at %.0f fps"), FrameRate));
+		return false;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateboarderWallCheck20FpsTest, "SkatePark.Skateboarder.WallCheck.Bounce20Fps",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSkateboarderWallCheck20FpsTest::RunTest(const FString& Parameters)
+{
+	return SkateboarderWallCheckTests::RunBounceTest(*this, 20.f);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateboarderWallCheck240FpsTest, "SkatePark.Skateboarder.WallCheck.Bounce240Fps",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSkateboarderWallCheck240FpsTest::RunTest(const FString& Parameters)
+{
+	return SkateboarderWallCheckTests::RunBounceTest(*this, 240.f);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateboarderWallCheckCostTest, "SkatePark.Skateboarder.WallCheck.Cost",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSkateboarderWallCheckCostTest::RunTest(const FString& Parameters)
+{
+	const SkateboarderWallCheckTests::FTestWorld TestWorld;
+	ASkateboarderCharacter* Skater = TestWorld.SpawnSkater();
+	if (!TestNotNull(TEXT("Skater"), Skater))
+	{
+		return false;
+	}
+
+	// Settle on the floor so every check runs against the same scene
+	for (int32 Frame = 0; Frame < 30; Frame++)
+	{
+		TestWorld.Tick(1.f / 60.f);
+	}
+
+	constexpr int32 Iterations = 10000;
+	const auto TimeChecks = [](TFunctionRef<void()> Check)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Iterations; Index++)
+		{
+			Check();
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+	};
+
+	const double LegacyCost = TimeChecks([Skater]() { Skater->LegacyWallCheck(); });
+	const double SweepCost = TimeChecks([Skater]()
+	{
+		Skater->bHasClearPath = false;
+		Skater->SweepWallCheck(1.f / 60.f);
+	});
+	const double CachedSweepCost = TimeChecks([Skater]() { Skater->SweepWallCheck(1.f / 60.f); });
+
+	AddInfo(FString::Printf(TEXT("Wall check per call: two rays %.2f us, capsule sweep %.2f us, cached capsule sweep %.2f us"),
+		LegacyCost, SweepCost, CachedSweepCost));
+	return true;
+}
+
+#endif
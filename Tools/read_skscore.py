@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Reads the score analytics files written to Saved/Analytics, see ScoreAnalyticsSubsystem.h for the layout.
+
+    read_skscore.py FILE...                  per volume hits and speeds
+    read_skscore.py --by skater FILE...      per skater hits, speeds and score
+    read_skscore.py --events FILE...         every event as CSV
+"""
+
+import argparse
+import csv
+import struct
+import sys
+from collections import defaultdict
+
+FILE_MAGIC = 0x43534B53
+FILE_VERSION = 1
+EVENTS_TAG = 0x53545645
+SUMMARY_TAG = 0x4D4D5553
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def at_end(self):
+        return self.offset >= len(self.data)
+
+    def read(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.data, self.offset)
+        self.offset += struct.calcsize("<" + fmt)
+        return values
+
+    def read_one(self, fmt):
+        return self.read(fmt)[0]
+
+    def read_string(self):
+        length = self.read_one("i")
+        value = self.data[self.offset:self.offset + length].decode("utf-8")
+        self.offset += length
+        return value
+
+    def read_column(self, fmt, count):
+        return list(self.read(f"{count}{fmt}")) if count else []
+
+
+def read_match(path):
+    """Returns the match id, map name, events as dicts and the summary (None if the match never ended)."""
+    with open(path, "rb") as file:
+        reader = Reader(file.read())
+
+    magic, version = reader.read("II")
+    if magic != FILE_MAGIC:
+        raise ValueError(f"{path} is not a score analytics file")
+    if version != FILE_VERSION:
+        raise ValueError(f"{path} has version {version}, this reader understands {FILE_VERSION}")
+
+    match_id = reader.read_string()
+    map_name = reader.read_string()
+    volumes = []
+    events = []
+    summary = None
+
+    while not reader.at_end():
+        tag = reader.read_one("I")
+        if tag == EVENTS_TAG:
+            volumes.extend(reader.read_string() for _ in range(reader.read_one("i")))
+            rows = reader.read_one("i")
+            columns = zip(
+                reader.read_column("f", rows),
+                reader.read_column("I", rows),
+                reader.read_column("i", rows),
+                reader.read_column("f", rows),
+                reader.read_column("i", rows),
+            )
+            for time, volume, skater, speed, score in columns:
+                events.append({
+                    "match": match_id, "map": map_name, "time": time, "volume": volumes[volume],
+                    "skater": skater, "speed": speed, "score": score,
+                })
+        elif tag == SUMMARY_TAG:
+            count = reader.read_one("i")
+            hits = reader.read_column("i", count)
+            max_speeds = reader.read_column("f", count)
+            mean_speeds = reader.read_column("f", count)
+            summary = {
+                "volumes": {volumes[index]: (hits[index], max_speeds[index], mean_speeds[index]) for index in range(count)},
+                "dropped": reader.read_one("I"),
+            }
+        else:
+            raise ValueError(f"{path} has an unknown block tag {tag:#010x} at offset {reader.offset - 4}")
+
+    return match_id, map_name, events, summary
+
+
+def aggregate(events, key):
+    groups = defaultdict(lambda: {"hits": 0, "score": 0, "speed_sum": 0.0, "max_speed": 0.0})
+    for event in events:
+        group = groups[event[key]]
+        group["hits"] += 1
+        group["score"] += event["score"]
+        group["speed_sum"] += event["speed"]
+        group["max_speed"] = max(group["max_speed"], event["speed"])
+    return groups
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+")
+    parser.add_argument("--by", choices=["volume", "skater", "match"], default="volume")
+    parser.add_argument("--events", action="store_true", help="dump every event instead of aggregating")
+    args = parser.parse_args()
+
+    events = []
+    dropped = 0
+    for path in args.files:
+        _, _, match_events, summary = read_match(path)
+        events.extend(match_events)
+        if summary:
+            dropped += summary["dropped"]
+
+    writer = csv.writer(sys.stdout)
+    if args.events:
+        writer.writerow(["match", "map", "time", "volume", "skater", "speed", "score"])
+        for event in events:
+            writer.writerow([event[column] for column in ("match", "map", "time", "volume", "skater", "speed", "score")])
+    else:
+        writer.writerow([args.by, "hits", "score", "mean_speed", "max_speed"])
+        groups = aggregate(events, args.by)
+        for name, group in sorted(groups.items(), key=lambda item: -item[1]["hits"]):
+            writer.writerow([name, group["hits"], group["score"], f"{group['speed_sum'] / group['hits']:.1f}", f"{group['max_speed']:.1f}"])
+
+    if dropped:
+        print(f"warning: {dropped} events were dropped while recording", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()